@@ -7,6 +7,8 @@
 #include <map>
 #include <syncstream>
 #include <algorithm>
+#include <array>
+#include <utility>
 
 using namespace std::chrono_literals;
 
@@ -37,6 +39,34 @@ void print_progress(const std::string &msg, const std::string& first_id, Employe
     std::cout << ss.str();
 }
 
+// List of all (i, j) index pairs with i < j for a group of N employees, generated at compile time.
+template<std::size_t N>
+constexpr auto make_partner_pairs()
+{
+    std::array<std::pair<std::size_t, std::size_t>, N * (N - 1) / 2> pairs{};
+    for (std::size_t count{}, i{}; i < N; ++i)
+        for (std::size_t j{i + 1}; j < N; ++j)
+            pairs[count++] = {i, j};
+    return pairs;
+}
+
+template<std::size_t N>
+constexpr auto partner_pairs = make_partner_pairs<N>();
+
+template<std::size_t N, std::size_t... P>
+void update_lunch_counters(const std::array<Employee*, N>& group, std::index_sequence<P...>)
+{
+    ((++group[partner_pairs<N>[P].first]->lunch_partners_counter[group[partner_pairs<N>[P].second]->id],
+      ++group[partner_pairs<N>[P].second]->lunch_partners_counter[group[partner_pairs<N>[P].first]->id]), ...);
+}
+
+// Group size known at compile time - all N*(N-1)/2 pair updates are unrolled, no per-call vector.
+template<std::size_t N>
+void update_lunch_counters(const std::array<Employee*, N>& group)
+{
+    update_lunch_counters(group, std::make_index_sequence<partner_pairs<N>.size()>{});
+}
+
 template<typename... Employees>
 void assign_lunch_partners(Employee& first, Employees&... partners)
 {
@@ -50,17 +80,7 @@ void assign_lunch_partners(Employee& first, Employees&... partners)
     print_progress(" got locks.", first.id, std::forward<Employees>(partners).id...);
 
     // Update the lunch counters for each pair of employees.
-    ((++first.lunch_partners_counter[partners.id] && ++partners.lunch_partners_counter[first.id]), ...);
-    std::vector<std::reference_wrapper<Employee>> emp_list = {partners...};
-    for (size_t i = 0; i < emp_list.size(); ++i) {
-        for (size_t j = i + 1; j < emp_list.size(); ++j) {
-            Employee& f = emp_list[i];
-            Employee& s = emp_list[j];
-
-            ++f.lunch_partners_counter[s.id];
-            ++s.lunch_partners_counter[f.id];
-        }
-    }
+    update_lunch_counters(std::array{&first, &partners...});
 
     // Wait a while
     std::this_thread::sleep_for(100ms);
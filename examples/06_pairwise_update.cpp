@@ -0,0 +1,156 @@
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+constexpr int max_update_iterations{20'000}; // the benchmark time tuning
+constexpr int max_runs{8};
+
+struct Employee
+{
+    std::map<std::string, uint64_t> lunch_partners_counter;
+    std::string id;
+
+    Employee(std::string id) : id(id) {}
+};
+
+inline auto now() noexcept { return std::chrono::high_resolution_clock::now(); }
+
+// Current implementation from 03_deadlock.cpp - fold for first vs rest, runtime loop for the remaining pairs.
+template<typename... Employees>
+void update_lunch_counters_loop(Employee& first, Employees&... partners)
+{
+    ((++first.lunch_partners_counter[partners.id] && ++partners.lunch_partners_counter[first.id]), ...);
+    std::vector<std::reference_wrapper<Employee>> emp_list = {partners...};
+    for (size_t i = 0; i < emp_list.size(); ++i) {
+        for (size_t j = i + 1; j < emp_list.size(); ++j) {
+            Employee& f = emp_list[i];
+            Employee& s = emp_list[j];
+
+            ++f.lunch_partners_counter[s.id];
+            ++s.lunch_partners_counter[f.id];
+        }
+    }
+}
+
+template<std::size_t N>
+constexpr auto make_partner_pairs()
+{
+    std::array<std::pair<std::size_t, std::size_t>, N * (N - 1) / 2> pairs{};
+    for (std::size_t count{}, i{}; i < N; ++i)
+        for (std::size_t j{i + 1}; j < N; ++j)
+            pairs[count++] = {i, j};
+    return pairs;
+}
+
+template<std::size_t N>
+constexpr auto partner_pairs = make_partner_pairs<N>();
+
+template<std::size_t N, std::size_t... P>
+void update_lunch_counters(const std::array<Employee*, N>& group, std::index_sequence<P...>)
+{
+    ((++group[partner_pairs<N>[P].first]->lunch_partners_counter[group[partner_pairs<N>[P].second]->id],
+      ++group[partner_pairs<N>[P].second]->lunch_partners_counter[group[partner_pairs<N>[P].first]->id]), ...);
+}
+
+template<std::size_t N>
+void update_lunch_counters(const std::array<Employee*, N>& group)
+{
+    update_lunch_counters(group, std::make_index_sequence<partner_pairs<N>.size()>{});
+}
+
+void update_lunch_counters(std::span<Employee* const> group)
+{
+    for (std::size_t i{}; i < group.size(); ++i)
+        for (std::size_t j{i + 1}; j < group.size(); ++j)
+        {
+            ++group[i]->lunch_partners_counter[group[j]->id];
+            ++group[j]->lunch_partners_counter[group[i]->id];
+        }
+}
+
+template<typename Update>
+double measure(Update update)
+{
+    const auto start{now()};
+
+    for (int count{}; count != max_update_iterations; ++count)
+        update();
+
+    return std::chrono::duration<double, std::milli>{now() - start}.count();
+}
+
+// Every pair has to be counted exactly max_update_iterations times.
+bool verify(std::span<Employee* const> group)
+{
+    for (const auto* employee : group)
+    {
+        if (employee->lunch_partners_counter.size() != group.size() - 1)
+            return false;
+        for (const auto& partner : employee->lunch_partners_counter)
+            if (partner.second != max_update_iterations)
+                return false;
+    }
+    return true;
+}
+
+template<std::size_t N, std::size_t... I>
+void benchmark(std::index_sequence<I...>)
+{
+    std::array<std::unique_ptr<Employee>, N> employees{std::make_unique<Employee>(std::to_string(I))...};
+    std::array<Employee*, N> group{employees[I].get()...};
+
+    // Counters are zeroed, not erased, so timed runs only look up existing map nodes.
+    auto reset = [&group]() {
+        for (auto* employee : group)
+            for (auto& partner : employee->lunch_partners_counter)
+                partner.second = 0;
+    };
+
+    constexpr std::size_t variants{3}; // loop, unrolled, span
+    auto run = [&group, &reset](std::size_t variant) {
+        reset();
+        switch (variant)
+        {
+            case 0: return measure([&group]() { update_lunch_counters_loop(*group[I]...); });
+            case 1: return measure([&group]() { update_lunch_counters(group); });
+            default: return measure([&group]() { update_lunch_counters(std::span<Employee* const>{group}); });
+        }
+    };
+
+    // Warm-up pass - creates the map nodes and warms the caches before anything is timed.
+    for (std::size_t variant{}; variant != variants; ++variant)
+        run(variant);
+
+    std::array<double, variants> time{};
+    bool ok = true;
+    for (int i{0}; i != max_runs; ++i)
+        // Rotate the order of the variants so none of them always runs first.
+        for (std::size_t count{}; count != variants; ++count)
+        {
+            const std::size_t variant{(i + count) % variants};
+            time[variant] += run(variant) / max_runs;
+            ok = ok && verify(group);
+        }
+
+    std::cout << "N = " << N << ": loop " << time[0] << " ms, unrolled " << time[1]
+              << " ms, span " << time[2] << " ms, ratio loop/unrolled:~ " << time[0] / time[1]
+              << (ok ? "" : " (COUNTERS MISMATCH)") << '\n';
+}
+
+template<std::size_t... N>
+void benchmark_all(std::index_sequence<N...>)
+{
+    (benchmark<N + 2>(std::make_index_sequence<N + 2>{}), ...);
+}
+
+int main()
+{
+    benchmark_all(std::make_index_sequence<15>{}); // N = 2..16
+}
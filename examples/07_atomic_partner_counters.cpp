@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <latch>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __cpp_lib_hardware_interference_size
+using std::hardware_destructive_interference_size;
+#else
+// 64 bytes on x86-64 │ L1_CACHE_BYTES │ L1_CACHE_SHIFT │ __cacheline_aligned │ ...
+    constexpr std::size_t hardware_destructive_interference_size = 64;
+#endif
+
+constexpr int max_assign_iterations{20'000}; // the benchmark time tuning
+constexpr int max_runs{4};
+constexpr std::size_t group_size{4};
+
+constexpr std::size_t factorial(std::size_t n) { return n <= 1 ? 1 : n * factorial(n - 1); }
+
+constexpr std::size_t threads_count{factorial(group_size)}; // one thread per permutation of the group
+
+inline auto now() noexcept { return std::chrono::high_resolution_clock::now(); }
+
+// Mutex guarded map - counters created on demand, whole group locked for every assignment.
+struct Employee
+{
+    std::map<std::string, uint64_t> lunch_partners_counter;
+    std::string id;
+    std::mutex m;
+
+    Employee(std::string id) : id(id) {}
+};
+
+template<std::size_t... I>
+void assign_lunch_partners(const std::array<Employee*, group_size>& group, std::index_sequence<I...>)
+{
+    std::scoped_lock lock(group[I]->m...);
+
+    for (std::size_t i{}; i < group_size; ++i)
+        for (std::size_t j{i + 1}; j < group_size; ++j)
+        {
+            ++group[i]->lunch_partners_counter[group[j]->id];
+            ++group[j]->lunch_partners_counter[group[i]->id];
+        }
+}
+
+// Group membership known up front - one preallocated atomic slot per (employee, partner), no mutex needed.
+// Every thread increments every live slot, so this is true sharing: putting each slot on its own
+// cache line would not change anything, the line still has to move between cores on each fetch_add.
+struct SharedCounters
+{
+    std::array<std::atomic_uint64_t, group_size * group_size> slots{};
+
+    void add(std::size_t, std::size_t employee, std::size_t partner)
+    {
+        // Only the final sums matter, no ordering with other memory is required.
+        slots[employee * group_size + partner].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t load(std::size_t employee, std::size_t partner) const
+    {
+        return slots[employee * group_size + partner].load();
+    }
+};
+
+// One shard per thread, summed at read time. Each slot has a single writer, so a relaxed load and store
+// are enough. Stored slot-major the shards of neighbouring threads share cache lines (false sharing).
+struct InterleavedShards
+{
+    std::array<std::array<std::atomic_uint64_t, threads_count>, group_size * group_size> slots{};
+
+    void add(std::size_t thread, std::size_t employee, std::size_t partner)
+    {
+        auto& slot = slots[employee * group_size + partner][thread];
+        slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t load(std::size_t employee, std::size_t partner) const
+    {
+        uint64_t sum{};
+        for (const auto& slot : slots[employee * group_size + partner])
+            sum += slot.load();
+        return sum;
+    }
+};
+
+// Same shards, each one starting on its own cache line (see 02_false_sharing.cpp).
+struct PaddedShards
+{
+    struct alignas(hardware_destructive_interference_size) Shard
+    {
+        std::array<std::atomic_uint64_t, group_size * group_size> slots{};
+    };
+
+    std::array<Shard, threads_count> shards{};
+
+    void add(std::size_t thread, std::size_t employee, std::size_t partner)
+    {
+        auto& slot = shards[thread].slots[employee * group_size + partner];
+        slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t load(std::size_t employee, std::size_t partner) const
+    {
+        uint64_t sum{};
+        for (const auto& shard : shards)
+            sum += shard.slots[employee * group_size + partner].load();
+        return sum;
+    }
+};
+
+template<typename Counters>
+void assign_lunch_partners(Counters& counters, std::size_t thread, const std::array<std::size_t, group_size>& group)
+{
+    for (std::size_t i{}; i < group_size; ++i)
+        for (std::size_t j{i + 1}; j < group_size; ++j)
+        {
+            counters.add(thread, group[i], group[j]);
+            counters.add(thread, group[j], group[i]);
+        }
+}
+
+// Runs one thread per permutation of the group, as in 03_deadlock.cpp, and returns increments per ms.
+// All threads are created first and released together by a latch. Each thread records its own start and
+// end, so thread creation, join and the scheduling of main are not timed - only the contended part.
+template<typename Assign>
+double measure(const std::string& name, Assign assign)
+{
+    std::array<std::size_t, group_size> set{};
+    std::iota(set.begin(), set.end(), 0);
+
+    using time_point = std::chrono::high_resolution_clock::time_point;
+    std::array<time_point, threads_count> starts, ends;
+    std::latch ready{threads_count};
+    {
+        std::vector<std::jthread> threads;
+        std::size_t thread{};
+        do {
+            threads.emplace_back([thread, set, &assign, &ready, &starts, &ends]() {
+                ready.arrive_and_wait();
+                starts[thread] = now();
+                for (int count{}; count != max_assign_iterations; ++count)
+                    assign(thread, set);
+                ends[thread] = now();
+            });
+            ++thread;
+        } while (std::next_permutation(set.begin(), set.end()));
+    }
+    const std::chrono::duration<double, std::milli> elapsed{
+        *std::max_element(ends.begin(), ends.end()) - *std::min_element(starts.begin(), starts.end())};
+
+    const double increments = 1.0 * threads_count * max_assign_iterations * group_size * (group_size - 1);
+    const double throughput = increments / elapsed.count();
+    std::cout << name << " spent " << elapsed.count() << " ms, " << throughput << " increments/ms\n";
+    return throughput;
+}
+
+// Every pair has to be counted exactly once per assignment of every thread.
+bool verify(const std::map<std::size_t, Employee>& employees)
+{
+    for (const auto& employee : employees)
+    {
+        if (employee.second.lunch_partners_counter.size() != group_size - 1)
+            return false;
+        for (const auto& partner : employee.second.lunch_partners_counter)
+            if (partner.second != threads_count * max_assign_iterations)
+                return false;
+    }
+    return true;
+}
+
+template<typename Counters>
+bool verify(const Counters& counters)
+{
+    for (std::size_t i{}; i < group_size; ++i)
+        for (std::size_t j{}; j < group_size; ++j)
+            if (i != j && counters.load(i, j) != threads_count * max_assign_iterations)
+                return false;
+    return true;
+}
+
+int main()
+{
+    std::map<std::size_t, Employee> employees;
+    for (std::size_t i{}; i < group_size; ++i)
+        employees.emplace(i, std::string(1, static_cast<char>('A' + i)));
+
+    double mutex_average{}, shared_average{}, interleaved_average{}, padded_average{};
+    bool ok = true;
+    for (auto i{0}; i != max_runs; ++i)
+    {
+        for (auto& employee : employees)
+            for (auto& partner : employee.second.lunch_partners_counter)
+                partner.second = 0;
+        mutex_average += measure("Mutex guarded map", [&employees](std::size_t, const auto& set) {
+            std::array<Employee*, group_size> group{};
+            std::transform(set.begin(), set.end(), group.begin(), [&employees](std::size_t i) { return &employees.at(i); });
+            assign_lunch_partners(group, std::make_index_sequence<group_size>{});
+        }) / max_runs;
+        ok = ok && verify(employees);
+
+        auto shared = std::make_unique<SharedCounters>();
+        shared_average += measure("Shared atomic slots", [&shared](std::size_t thread, const auto& set) {
+            assign_lunch_partners(*shared, thread, set);
+        }) / max_runs;
+        ok = ok && verify(*shared);
+
+        auto interleaved = std::make_unique<InterleavedShards>();
+        interleaved_average += measure("Interleaved shards", [&interleaved](std::size_t thread, const auto& set) {
+            assign_lunch_partners(*interleaved, thread, set);
+        }) / max_runs;
+        ok = ok && verify(*interleaved);
+
+        auto padded = std::make_unique<PaddedShards>();
+        padded_average += measure("Padded shards", [&padded](std::size_t thread, const auto& set) {
+            assign_lunch_partners(*padded, thread, set);
+        }) / max_runs;
+        ok = ok && verify(*padded);
+
+        std::cout << '\n';
+    }
+
+    if (!ok)
+        std::cout << "COUNTERS MISMATCH\n";
+
+    std::cout << "Threads: " << threads_count << ", runs: " << max_runs << '\n'
+              << "Average ratio shared/mutex:~ " << shared_average / mutex_average << '\n'
+              << "Average ratio padded/mutex:~ " << padded_average / mutex_average << '\n'
+              << "Average ratio padded/interleaved:~ " << padded_average / interleaved_average << '\n';
+}